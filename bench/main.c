@@ -0,0 +1,171 @@
+// Measures how the memory order of the nodes affects tree_compute_layout and a
+// plain traversal, run with the heights of the full trees to benchmark, e.g.
+//     ./bench_tidier_trees 20 24 27
+// for trees of 1M, 16M and 134M nodes
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+
+#include "trees.h"
+
+// Returns a counter of the cache misses of this thread, or -1 when perf
+// counters are unavailable (e.g. perf_event_paranoid or inside a container)
+static int open_cache_miss_counter(void) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static double seconds_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+struct measurement_t {
+    double seconds;
+    long long cache_misses;
+};
+
+static void measure_start(int counter) {
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+static struct measurement_t measure_stop(int counter, double start) {
+    struct measurement_t measurement = { .seconds = seconds_now() - start, .cache_misses = -1 };
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(counter, &measurement.cache_misses, sizeof(measurement.cache_misses)) != sizeof(long long)) {
+            measurement.cache_misses = -1;
+        }
+    }
+    return measurement;
+}
+
+static void print_measurement(const char* order, const char* workload, int num_nodes, struct measurement_t measurement) {
+    printf("%-14s %-10s %12d nodes %9.3f s", order, workload, num_nodes, measurement.seconds);
+    if (measurement.cache_misses >= 0) {
+        printf(" %14lld cache misses %8.3f per node", measurement.cache_misses,
+               (double)measurement.cache_misses / num_nodes);
+    }
+    printf("\n");
+}
+
+static struct tree_t* scattered_copy_helper(struct tree_t* tree, struct tree_t** nodes, int* next) {
+    if (!tree) {
+        return NULL;
+    }
+    struct tree_t* node = nodes[(*next)++];
+    *node = *tree;
+    node->left_child = scattered_copy_helper(tree->left_child, nodes, next);
+    node->right_child = scattered_copy_helper(tree->right_child, nodes, next);
+    return node;
+}
+
+// Copies the tree into individually malloc'd nodes handed out in a shuffled
+// order, like the heap of a long running program where neighbouring nodes
+// were allocated far apart. Freed with tree_free, NULL if a node could not be
+// allocated
+static struct tree_t* scattered_copy(struct tree_t* tree, int num_nodes) {
+    struct tree_t** nodes = malloc(sizeof(struct tree_t*) * (size_t)num_nodes);
+    if (!nodes) {
+        return NULL;
+    }
+    for (int i = 0; i < num_nodes; i++) {
+        nodes[i] = malloc(sizeof(struct tree_t));
+        if (!nodes[i]) {
+            for (int j = 0; j < i; j++) {
+                free(nodes[j]);
+            }
+            free(nodes);
+            return NULL;
+        }
+    }
+    for (int i = num_nodes - 1; i > 0; i--) {
+        int swap = rand() % (i + 1);
+        struct tree_t* node = nodes[i];
+        nodes[i] = nodes[swap];
+        nodes[swap] = node;
+    }
+    int next = 0;
+    struct tree_t* copy = scattered_copy_helper(tree, nodes, &next);
+    free(nodes);
+    return copy;
+}
+
+static void bench_tree(const char* order, struct tree_t* tree, int num_nodes, int counter) {
+    double start = seconds_now();
+    measure_start(counter);
+    tree_compute_layout(tree);
+    print_measurement(order, "layout", num_nodes, measure_stop(counter, start));
+
+    start = seconds_now();
+    measure_start(counter);
+    int counted = tree_count_nodes(tree);
+    print_measurement(order, "traversal", counted, measure_stop(counter, start));
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <height>...\n", argv[0]);
+        return 1;
+    }
+    int counter = open_cache_miss_counter();
+    if (counter < 0) {
+        fprintf(stderr, "perf counters unavailable, only reporting times\n");
+    }
+
+    const char* order_names[] = { "preorder", "postorder", "bfs", "van-emde-boas" };
+    const enum tree_order_t orders[] = {
+        TREE_ORDER_PREORDER, TREE_ORDER_POSTORDER, TREE_ORDER_BFS, TREE_ORDER_VAN_EMDE_BOAS
+    };
+
+    for (int arg = 1; arg < argc; arg++) {
+        const int height = atoi(argv[arg]);
+        struct tree_t* tree = tree_random(height, height, 0.0f);
+        const int num_nodes = tree_count_nodes(tree);
+        // tree_random allocates one node after another from a fresh heap, so
+        // these nodes already sit in roughly contiguous preorder
+        bench_tree("malloc (seq)", tree, num_nodes, counter);
+
+        struct tree_t* scattered = scattered_copy(tree, num_nodes);
+        if (scattered) {
+            bench_tree("malloc (shuf)", scattered, num_nodes, counter);
+            tree_free(scattered);
+        } else {
+            fprintf(stderr, "could not allocate %d scattered nodes\n", num_nodes);
+        }
+
+        for (int i = 0; i < 4; i++) {
+            struct tree_block_t block = tree_relayout_memory(tree, orders[i]);
+            if (!block.nodes) {
+                fprintf(stderr, "could not allocate %d nodes\n", num_nodes);
+                break;
+            }
+            bench_tree(order_names[i], block.root, num_nodes, counter);
+            tree_block_free(&block);
+        }
+        tree_free(tree);
+    }
+
+    if (counter >= 0) {
+        close(counter);
+    }
+    return 0;
+}
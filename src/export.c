@@ -0,0 +1,216 @@
+#include "export.h"
+#include "utils.h"
+#include <math.h>
+#include <stdlib.h>
+
+static void bounds_helper(struct tree_t* tree, struct tree_bounds_t* bounds) {
+    if (!tree) {
+        return;
+    }
+    bounds->min_x_pos = min_int(bounds->min_x_pos, tree->x_pos);
+    bounds->max_x_pos = max_int(bounds->max_x_pos, tree->x_pos);
+    bounds->max_y_pos = max_int(bounds->max_y_pos, tree->y_pos);
+    bounds_helper(tree->left_child, bounds);
+    bounds_helper(tree->right_child, bounds);
+}
+
+struct tree_bounds_t tree_bounds(struct tree_t* tree, float x_scale, float y_scale) {
+    struct tree_bounds_t bounds = { .x_scale = x_scale, .y_scale = y_scale };
+    if (tree) {
+        bounds.min_x_pos = bounds.max_x_pos = tree->x_pos;
+        bounds.max_y_pos = tree->y_pos;
+        bounds_helper(tree, &bounds);
+    }
+    const float node_scale = fminf(x_scale / HORIZONTAL_SCALE, y_scale / VERTICAL_SPACING);
+    bounds.node_radius = (int)(NODE_RADIUS * node_scale);
+    bounds.margin = max_int((int)((float)EXPORT_MARGIN * node_scale), 1);
+    bounds.width = (int)((float)(bounds.max_x_pos - bounds.min_x_pos) * x_scale) + 2 * bounds.margin;
+    bounds.height = (int)((float)bounds.max_y_pos * y_scale) + 2 * bounds.margin;
+    return bounds;
+}
+
+float tree_fit_x_scale(struct tree_t* tree, int width) {
+    struct tree_bounds_t bounds = tree_bounds(tree, HORIZONTAL_SCALE, VERTICAL_SPACING);
+    const int span = bounds.max_x_pos - bounds.min_x_pos;
+    if (span == 0) {
+        return HORIZONTAL_SCALE;
+    }
+    // leaves room for the margin, which is at most EXPORT_MARGIN on each side
+    return fminf((float)(width - 2 * EXPORT_MARGIN) / (float)span, HORIZONTAL_SCALE);
+}
+
+static int pixel_x(struct tree_t* tree, struct tree_bounds_t* bounds) {
+    return (int)((float)(tree->x_pos - bounds->min_x_pos) * bounds->x_scale) + bounds->margin;
+}
+
+static int pixel_y(struct tree_t* tree, struct tree_bounds_t* bounds) {
+    return (int)((float)tree->y_pos * bounds->y_scale) + bounds->margin;
+}
+
+static void svg_edges(struct tree_t* tree, struct tree_bounds_t* bounds, FILE* out) {
+    struct tree_t* children[] = { tree->left_child, tree->right_child };
+    for (int i = 0; i < 2; i++) {
+        if (children[i]) {
+            fprintf(out, "<line x1=\"%d\" y1=\"%d\" x2=\"%d\" y2=\"%d\"/>\n",
+                    pixel_x(tree, bounds), pixel_y(tree, bounds),
+                    pixel_x(children[i], bounds), pixel_y(children[i], bounds));
+            svg_edges(children[i], bounds, out);
+        }
+    }
+}
+
+static void svg_nodes(struct tree_t* tree, struct tree_bounds_t* bounds, FILE* out) {
+    if (!tree) {
+        return;
+    }
+    fprintf(out, "<circle id=\"n%d\" cx=\"%d\" cy=\"%d\" r=\"%d\"/>\n",
+            tree->id, pixel_x(tree, bounds), pixel_y(tree, bounds), bounds->node_radius);
+    svg_nodes(tree->left_child, bounds, out);
+    svg_nodes(tree->right_child, bounds, out);
+}
+
+bool tree_export_svg(struct tree_t* tree, FILE* out) {
+    // svg is scalable, so it is written at the viewer's scale
+    struct tree_bounds_t bounds = tree_bounds(tree, HORIZONTAL_SCALE, VERTICAL_SPACING);
+    fprintf(out, "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\" viewBox=\"0 0 %d %d\">\n",
+            bounds.width, bounds.height, bounds.width, bounds.height);
+    fprintf(out, "<rect width=\"100%%\" height=\"100%%\" fill=\"rgb(220,220,225)\"/>\n");
+
+    // edges are written first so the nodes are drawn over them
+    fprintf(out, "<g stroke=\"rgb(80,80,80)\" stroke-width=\"2\">\n");
+    if (tree) {
+        svg_edges(tree, &bounds, out);
+    }
+    fprintf(out, "</g>\n");
+
+    fprintf(out, "<g fill=\"rgb(100,150,200)\">\n");
+    svg_nodes(tree, &bounds, out);
+    fprintf(out, "</g>\n</svg>\n");
+
+    return !ferror(out);
+}
+
+static int compute_extents(struct tree_t* tree, struct subtree_extent_t* extents, int index) {
+    if (!tree) {
+        return 0;
+    }
+    struct subtree_extent_t extent = { .min_x_pos = tree->x_pos, .max_x_pos = tree->x_pos, .size = 1 };
+    int left_size = compute_extents(tree->left_child, extents, index + 1);
+    int right_size = compute_extents(tree->right_child, extents, index + 1 + left_size);
+    if (left_size) {
+        extent.min_x_pos = min_int(extent.min_x_pos, extents[index + 1].min_x_pos);
+        extent.max_x_pos = max_int(extent.max_x_pos, extents[index + 1].max_x_pos);
+    }
+    if (right_size) {
+        extent.min_x_pos = min_int(extent.min_x_pos, extents[index + 1 + left_size].min_x_pos);
+        extent.max_x_pos = max_int(extent.max_x_pos, extents[index + 1 + left_size].max_x_pos);
+    }
+    extent.size += left_size + right_size;
+    extents[index] = extent;
+    return extent.size;
+}
+
+struct subtree_extent_t* tree_subtree_extents(struct tree_t* tree) {
+    const int num_nodes = tree_count_nodes(tree);
+    struct subtree_extent_t* extents = malloc(sizeof(struct subtree_extent_t) * (size_t)max_int(num_nodes, 1));
+    if (extents) {
+        compute_extents(tree, extents, 0);
+    }
+    return extents;
+}
+
+// Raster local pixel coordinates of a layout position
+static int raster_x(struct tree_raster_t* raster, int x_pos) {
+    return (int)((float)(x_pos - raster->bounds.min_x_pos) * raster->bounds.x_scale) + raster->bounds.margin - raster->x0;
+}
+
+static int raster_y(struct tree_raster_t* raster, int y_pos) {
+    return (int)((float)y_pos * raster->bounds.y_scale) + raster->bounds.margin - raster->y0;
+}
+
+static void fill_span(struct tree_raster_t* raster, int y, int from_x, int to_x, uint32_t color) {
+    if (y < 0 || y >= raster->height) {
+        return;
+    }
+    from_x = max_int(from_x, 0);
+    to_x = min_int(to_x, raster->width - 1);
+    uint32_t* row = raster->pixels + (size_t)y * (size_t)raster->pitch;
+    for (int x = from_x; x <= to_x; x++) {
+        row[x] = color;
+    }
+}
+
+static void draw_circle(struct tree_raster_t* raster, int cx, int cy) {
+    const int radius = raster->bounds.node_radius;
+    for (int dy = -radius; dy <= radius; dy++) {
+        int dx = (int)sqrtf((float)(radius * radius - dy * dy));
+        fill_span(raster, cy + dy, cx - dx, cx + dx, EXPORT_NODE_COLOR);
+    }
+}
+
+// Draws the edge one row at a time, so a very wide edge costs its height plus
+// the pixels that land inside the raster rather than its full length
+static void draw_edge(struct tree_raster_t* raster, int x0, int y0, int x1, int y1) {
+    if (y1 <= y0) {
+        return;
+    }
+    const int height = y1 - y0;
+    for (int dy = 0; dy < height; dy++) {
+        int from_x = x0 + (int)((long long)(x1 - x0) * dy / height);
+        int to_x = x0 + (int)((long long)(x1 - x0) * (dy + 1) / height);
+        fill_span(raster, y0 + dy, min_int(from_x, to_x), max_int(from_x, to_x) + 1, EXPORT_EDGE_COLOR);
+    }
+}
+
+// Returns true when the subtree at index can't touch the raster
+static bool subtree_outside_raster(struct tree_raster_t* raster, struct tree_t* tree, int index) {
+    struct subtree_extent_t extent = raster->extents[index];
+    const int radius = raster->bounds.node_radius + 1;
+    return raster_x(raster, extent.max_x_pos) + radius < 0 ||
+           raster_x(raster, extent.min_x_pos) - radius >= raster->width ||
+           raster_y(raster, tree->y_pos) - radius >= raster->height;
+}
+
+static void draw_edges(struct tree_raster_t* raster, struct tree_t* tree, int index) {
+    if (!tree || subtree_outside_raster(raster, tree, index)) {
+        return;
+    }
+    int left_size = tree->left_child ? raster->extents[index + 1].size : 0;
+    int children_index[] = { index + 1, index + 1 + left_size };
+    struct tree_t* children[] = { tree->left_child, tree->right_child };
+    for (int i = 0; i < 2; i++) {
+        if (children[i]) {
+            draw_edge(raster, raster_x(raster, tree->x_pos), raster_y(raster, tree->y_pos),
+                      raster_x(raster, children[i]->x_pos), raster_y(raster, children[i]->y_pos));
+            draw_edges(raster, children[i], children_index[i]);
+        }
+    }
+}
+
+static void draw_nodes(struct tree_raster_t* raster, struct tree_t* tree, int index) {
+    if (!tree || subtree_outside_raster(raster, tree, index)) {
+        return;
+    }
+    draw_circle(raster, raster_x(raster, tree->x_pos), raster_y(raster, tree->y_pos));
+    int left_size = tree->left_child ? raster->extents[index + 1].size : 0;
+    draw_nodes(raster, tree->left_child, index + 1);
+    draw_nodes(raster, tree->right_child, index + 1 + left_size);
+}
+
+void tree_rasterize(struct tree_t* tree, struct tree_raster_t* raster) {
+    for (int y = 0; y < raster->height; y++) {
+        fill_span(raster, y, 0, raster->width - 1, EXPORT_BACKGROUND_COLOR);
+    }
+    // edges are drawn first so the nodes are drawn over them
+    draw_edges(raster, tree, 0);
+    draw_nodes(raster, tree, 0);
+}
+
+void tree_tile_grid(struct tree_bounds_t* bounds, int* rows, int* columns) {
+    *rows = (bounds->height + EXPORT_TILE_SIZE - 1) / EXPORT_TILE_SIZE;
+    *columns = (bounds->width + EXPORT_TILE_SIZE - 1) / EXPORT_TILE_SIZE;
+}
+
+void tree_tile_path(char* path, size_t size, const char* prefix, int row, int column) {
+    snprintf(path, size, "%s_%d_%d.png", prefix, row, column);
+}
@@ -0,0 +1,81 @@
+#ifndef TIDIER_TREES_EXPORT_H
+#define TIDIER_TREES_EXPORT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "trees.h"
+
+// Configuration for tree rendering, shared by the viewer and the exporters
+#define NODE_RADIUS 20.0f
+#define VERTICAL_SPACING 60.0f
+#define HORIZONTAL_SCALE 30.0f
+
+// Blank space left around the tree in exported images at the viewer's scale,
+// like the node radius it shrinks with the export scale
+#define EXPORT_MARGIN 40
+
+// Side length in pixels of each png tile
+#define EXPORT_TILE_SIZE 4096
+
+// Colors of the exported images as ARGB8888 pixels
+#define EXPORT_BACKGROUND_COLOR 0xFFDCDCE1u
+#define EXPORT_NODE_COLOR 0xFF6496C8u
+#define EXPORT_EDGE_COLOR 0xFF505050u
+
+// The pixel extent of a laid out tree drawn with x_scale and y_scale pixels per
+// layout unit, x_pos can be negative so the tree is shifted by -min_x_pos when
+// drawn. The node radius and margin shrink with the smaller of the two scales
+// relative to the viewer's HORIZONTAL_SCALE and VERTICAL_SPACING
+struct tree_bounds_t {
+    int min_x_pos, max_x_pos, max_y_pos;
+    float x_scale, y_scale;
+    int node_radius, margin;
+    int width, height;
+};
+
+struct tree_bounds_t tree_bounds(struct tree_t* tree, float x_scale, float y_scale);
+
+// The x_scale that makes the laid out tree at most width pixels wide, never
+// larger than the viewer's HORIZONTAL_SCALE
+float tree_fit_x_scale(struct tree_t* tree, int width);
+
+// The x extent of every subtree, stored in preorder so that a tile can skip a
+// whole subtree (and the edges inside it) without visiting it
+struct subtree_extent_t {
+    int min_x_pos, max_x_pos;
+    int size;
+};
+
+// Returns a malloc'd array with the extent of every subtree, or NULL
+struct subtree_extent_t* tree_subtree_extents(struct tree_t* tree);
+
+// A window of the full exported image, x0 and y0 are its position in the image
+// and pitch is the number of pixels between the starts of two rows
+struct tree_raster_t {
+    uint32_t* pixels;
+    int width, height, pitch;
+    int x0, y0;
+    struct tree_bounds_t bounds;
+    struct subtree_extent_t* extents;
+};
+
+// Draws the part of the laid out tree that falls inside the raster
+void tree_rasterize(struct tree_t* tree, struct tree_raster_t* raster);
+
+// The number of EXPORT_TILE_SIZE tiles covering the image, and their file names
+void tree_tile_grid(struct tree_bounds_t* bounds, int* rows, int* columns);
+void tree_tile_path(char* path, size_t size, const char* prefix, int row, int column);
+
+// Streams the laid out tree as an svg document, nodes and edges are written as
+// they are visited so memory use does not grow with the size of the tree
+bool tree_export_svg(struct tree_t* tree, FILE* out);
+
+// Rasterizes the laid out tree at x_scale and y_scale pixels per layout unit
+// into EXPORT_TILE_SIZE png tiles named <prefix>_<row>_<column>.png, drawing
+// tiles in parallel on num_threads threads
+bool tree_export_png_tiles(struct tree_t* tree, const char* prefix, float x_scale, float y_scale, int num_threads);
+
+#endif //TIDIER_TREES_EXPORT_H
@@ -0,0 +1,115 @@
+#include "export.h"
+#include "utils.h"
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <stdlib.h>
+
+struct png_job_t {
+    struct tree_t* tree;
+    struct subtree_extent_t* extents;
+    struct tree_bounds_t bounds;
+    const char* prefix;
+    int rows, columns;
+    SDL_atomic_t next_tile;
+    SDL_atomic_t failed;
+};
+
+static bool render_tile(struct png_job_t* job, int row, int column) {
+    struct tree_raster_t raster = {
+        .x0 = column * EXPORT_TILE_SIZE,
+        .y0 = row * EXPORT_TILE_SIZE,
+        .bounds = job->bounds,
+        .extents = job->extents,
+    };
+    raster.width = min_int(EXPORT_TILE_SIZE, job->bounds.width - raster.x0);
+    raster.height = min_int(EXPORT_TILE_SIZE, job->bounds.height - raster.y0);
+
+    // ARGB8888 matches the EXPORT_*_COLOR pixels the rasterizer writes
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, raster.width, raster.height, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) {
+        fprintf(stderr, "Error: could not create tile surface: %s\n", SDL_GetError());
+        return false;
+    }
+    raster.pixels = surface->pixels;
+    raster.pitch = surface->pitch / (int)sizeof(uint32_t);
+    tree_rasterize(job->tree, &raster);
+
+    char path[4096];
+    tree_tile_path(path, sizeof(path), job->prefix, row, column);
+    bool saved = IMG_SavePNG(surface, path) == 0;
+    if (!saved) {
+        fprintf(stderr, "Error: could not save %s: %s\n", path, IMG_GetError());
+    }
+    SDL_FreeSurface(surface);
+    return saved;
+}
+
+// Each worker claims the next unrendered tile, so at most one tile surface per
+// thread is alive at a time
+static int png_worker(void* data) {
+    struct png_job_t* job = data;
+    const int num_tiles = job->rows * job->columns;
+    int tile;
+    while ((tile = SDL_AtomicAdd(&job->next_tile, 1)) < num_tiles) {
+        if (SDL_AtomicGet(&job->failed)) {
+            break;
+        }
+        if (!render_tile(job, tile / job->columns, tile % job->columns)) {
+            SDL_AtomicSet(&job->failed, 1);
+        }
+    }
+    return 0;
+}
+
+bool tree_export_png_tiles(struct tree_t* tree, const char* prefix, float x_scale, float y_scale, int num_threads) {
+    struct png_job_t job = {
+        .tree = tree,
+        .bounds = tree_bounds(tree, x_scale, y_scale),
+        .prefix = prefix,
+    };
+    tree_tile_grid(&job.bounds, &job.rows, &job.columns);
+    SDL_AtomicSet(&job.next_tile, 0);
+    SDL_AtomicSet(&job.failed, 0);
+
+    job.extents = tree_subtree_extents(tree);
+    if (!job.extents) {
+        return false;
+    }
+
+    // IMG_SavePNG initialises SDL_image on first use, which isn't thread safe,
+    // so it is initialised here before any worker starts
+    if ((IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) == 0) {
+        fprintf(stderr, "Error: could not initialize SDL_image: %s\n", IMG_GetError());
+        free(job.extents);
+        return false;
+    }
+
+    if (num_threads <= 0) {
+        num_threads = SDL_GetCPUCount();
+    }
+    num_threads = max_int(min_int(num_threads, job.rows * job.columns), 1);
+
+    // the calling thread renders too, which also covers any thread that failed to start
+    const int num_workers = num_threads - 1;
+    SDL_Thread** threads = malloc(sizeof(SDL_Thread*) * (size_t)max_int(num_workers, 1));
+    if (!threads) {
+        IMG_Quit();
+        free(job.extents);
+        return false;
+    }
+    for (int i = 0; i < num_workers; i++) {
+        threads[i] = SDL_CreateThread(png_worker, "png_tile", &job);
+    }
+    png_worker(&job);
+    for (int i = 0; i < num_workers; i++) {
+        if (threads[i]) {
+            SDL_WaitThread(threads[i], NULL);
+        }
+    }
+    IMG_Quit();
+
+    free(threads);
+    free(job.extents);
+    return !SDL_AtomicGet(&job.failed);
+}
@@ -3,10 +3,16 @@
 #include "renderers/SDL2/clay_renderer_SDL2.c"
 
 #include <SDL2/SDL.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
 
+#include "export.h"
+#include "tree_index.h"
 #include "trees.h"
+#include "utils.h"
 
 void HandleClayErrors(Clay_ErrorData errorData) {
     printf("%s", errorData.errorText.chars);
@@ -17,22 +23,111 @@ Clay_Color sidebarOrange = {221, 123, 24, 255 };
 Clay_Color borderGray = { 60, 60, 60, 255 };
 Clay_Color nodeColor = { 100, 150, 200, 255 };
 Clay_Color edgeColor = { 80, 80, 80, 255 };
+Clay_Color selectedColor = { 221, 123, 24, 255 };
+Clay_Color hoveredColor = { 150, 195, 240, 255 };
+
+// Elements the ui uses besides the tree nodes, with some headroom
+#define CLAY_UI_ELEMENT_COUNT 64
+
+// Clay sizes its render command array from the max element count too, and every
+// node is a floating element clipped to the TreeDisplay, so it renders as a
+// SCISSOR_START, its rectangle and a SCISSOR_END
+#define CLAY_COMMANDS_PER_NODE 3
+
+// Trees with more nodes than this are drawn directly with SDL instead of as
+// Clay elements, can be changed with --clay-node-cap
+#define DEFAULT_CLAY_NODE_CAP 4096
 
 typedef struct {
     float x_offset;
     float y_offset;
     struct tree_t* tree;
+    int num_nodes;
+
+    // Positions of the laid out nodes for hit testing, rebuilt with the layout
+    struct tree_index_t* index;
+    struct tree_index_entry_t* hovered;
+
+    // Last known mouse position in screen coordinates, hovered is recomputed from
+    // it every frame so panning moves the highlight with the tree
+    bool mouse_in_window;
+    float mouse_x, mouse_y;
+
+    // Rubber band selection, in screen coordinates
+    bool dragging;
+    float drag_start_x, drag_start_y;
+    float drag_x, drag_y;
+
+    // The Clay arena is sized from the tree that is currently shown
+    void* clay_memory;
+    int32_t clay_max_element_count;
+    int clay_node_cap;
 } app_data_t;
 
-// Configuration for tree rendering
-#define NODE_RADIUS 20.0f
-#define VERTICAL_SPACING 60.0f
-#define HORIZONTAL_SCALE 30.0f
+bool TreeDrawnWithClay(app_data_t* app_data) {
+    return app_data->num_nodes <= app_data->clay_node_cap;
+}
+
+// Reallocates the Clay arena when the current tree needs a different element
+// count, rounded up to a power of two so similar trees reuse the arena
+void ResizeClayArena(app_data_t* app_data, Clay_Dimensions dimensions) {
+    int32_t required = CLAY_UI_ELEMENT_COUNT +
+                       (TreeDrawnWithClay(app_data) ? CLAY_COMMANDS_PER_NODE * app_data->num_nodes : 0);
+    int32_t element_count = CLAY_UI_ELEMENT_COUNT;
+    while (element_count < required) {
+        element_count *= 2;
+    }
+    if (app_data->clay_memory && element_count == app_data->clay_max_element_count) {
+        return;
+    }
+
+    // the new context copies its limits from the current one, so the old arena
+    // is only freed after Clay_Initialize
+    Clay_SetMaxElementCount(element_count);
+    uint64_t totalMemorySize = Clay_MinMemorySize();
+    void* memory = malloc(totalMemorySize);
+    if (!memory) {
+        // keep the old arena and draw this tree without Clay instead
+        fprintf(stderr, "Error: could not allocate %llu bytes for Clay\n", (unsigned long long)totalMemorySize);
+        if (app_data->clay_memory) {
+            Clay_SetMaxElementCount(app_data->clay_max_element_count);
+        }
+        app_data->clay_node_cap = min_int(app_data->clay_node_cap, app_data->num_nodes - 1);
+        return;
+    }
+    Clay_Arena clayMemory = Clay_CreateArenaWithCapacityAndMemory(totalMemorySize, memory);
+    Clay_Initialize(clayMemory, dimensions, (Clay_ErrorHandler) { HandleClayErrors });
+
+    free(app_data->clay_memory);
+    app_data->clay_memory = memory;
+    app_data->clay_max_element_count = element_count;
+}
+
+// Rebuilds the hit testing index after the tree was laid out, keeping the
+// selection of nodes that are still in the tree
+void UpdateTreeIndex(app_data_t* app_data) {
+    struct tree_index_t* index = tree_index_build(app_data->tree);
+    if (index && app_data->index) {
+        tree_index_copy_selection(index, app_data->index);
+    }
+    tree_index_free(app_data->index);
+    app_data->index = index;
+    app_data->hovered = NULL;
+}
+
+Clay_Color NodeColor(app_data_t* app_data, struct tree_index_entry_t* entry) {
+    if (entry == app_data->hovered) {
+        return hoveredColor;
+    }
+    return entry->selected ? selectedColor : nodeColor;
+}
 
-// Recursive function to render tree nodes using Clay floating elements
-void RenderTreeNode(struct tree_t *node, float x_offset, float y_offset) {
-    if (node == NULL) return;
+bool ColorsEqual(Clay_Color a, Clay_Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
 
+// Renders a tree node as a Clay floating element
+void RenderTreeNode(struct tree_t *node, Clay_Color color, float x_offset, float y_offset) {
     // Calculate position (scaled to screen coordinates)
     float x = (float)node->x_pos * HORIZONTAL_SCALE + x_offset;
     float y = (float)node->y_pos * VERTICAL_SPACING + y_offset;
@@ -42,7 +137,7 @@ void RenderTreeNode(struct tree_t *node, float x_offset, float y_offset) {
         .layout = {
             .sizing = { CLAY_SIZING_FIXED(NODE_RADIUS * 2), CLAY_SIZING_FIXED(NODE_RADIUS * 2) }
         },
-        .backgroundColor = nodeColor,
+        .backgroundColor = color,
         .cornerRadius = CLAY_CORNER_RADIUS(NODE_RADIUS), // Makes it circular
         .floating = {
             .zIndex = 0,
@@ -51,10 +146,6 @@ void RenderTreeNode(struct tree_t *node, float x_offset, float y_offset) {
             .clipTo = CLAY_CLIP_TO_ATTACHED_PARENT
         },
     }) {}
-
-    // Recursively render children
-    RenderTreeNode(node->left_child, x_offset, y_offset);
-    RenderTreeNode(node->right_child, x_offset, y_offset);
 }
 
 Clay_RenderCommandArray CreateLayout(app_data_t* app_data) {
@@ -84,13 +175,18 @@ Clay_RenderCommandArray CreateLayout(app_data_t* app_data) {
             .border = { .color = borderGray, .width = CLAY_BORDER_ALL(4) },
             .clip = { .horizontal = true, .vertical = true }
         }) {
-            if (app_data->tree != NULL) {
+            if (app_data->tree != NULL && app_data->index != NULL) {
                 Clay_ElementData treeDisplayData = Clay_GetElementData(Clay_GetElementId(CLAY_STRING("TreeDisplay")));
 
                 float centerX = treeDisplayData.boundingBox.width / 2.0f - app_data->x_offset;
                 float centerY = 100.0f - app_data->y_offset;
 
-                RenderTreeNode(app_data->tree, centerX, centerY);
+                if (TreeDrawnWithClay(app_data)) {
+                    for (int i = 0; i < app_data->index->num_entries; i++) {
+                        struct tree_index_entry_t* entry = &app_data->index->entries[i];
+                        RenderTreeNode(entry->node, NodeColor(app_data, entry), centerX, centerY);
+                    }
+                }
             }
         }
     }
@@ -98,7 +194,264 @@ Clay_RenderCommandArray CreateLayout(app_data_t* app_data) {
     return Clay_EndLayout();
 }
 
+// Batches node rectangles so large trees cost one draw call per batch
+#define SDL_NODE_BATCH_SIZE 4096
+
+typedef struct {
+    SDL_Renderer* renderer;
+    SDL_Rect clip;
+    SDL_Rect batch[SDL_NODE_BATCH_SIZE];
+    int batch_size;
+} sdl_tree_batch_t;
+
+void FlushNodeBatch(sdl_tree_batch_t* batch) {
+    SDL_RenderFillRects(batch->renderer, batch->batch, batch->batch_size);
+    batch->batch_size = 0;
+}
+
+bool GetTreeDisplayBox(Clay_BoundingBox* box) {
+    Clay_ElementData treeDisplayData = Clay_GetElementData(Clay_GetElementId(CLAY_STRING("TreeDisplay")));
+    *box = treeDisplayData.boundingBox;
+    return treeDisplayData.found;
+}
+
+// Screen position of layout position (0, 0), matches the offsets used in CreateLayout
+void TreeOrigin(app_data_t* app_data, Clay_BoundingBox box, float* x, float* y) {
+    *x = box.x + box.width / 2.0f - app_data->x_offset;
+    *y = box.y + 100.0f - app_data->y_offset;
+}
+
+void ScreenToLayout(app_data_t* app_data, Clay_BoundingBox box, float x, float y, float* x_pos, float* y_pos) {
+    float originX, originY;
+    TreeOrigin(app_data, box, &originX, &originY);
+    *x_pos = (x - originX) / HORIZONTAL_SCALE;
+    *y_pos = (y - originY) / VERTICAL_SPACING;
+}
+
+// Draws the nodes of one color that fall inside the clip rect, only the
+// visible part of each level is visited
+void DrawVisibleNodesSDL(sdl_tree_batch_t* batch, app_data_t* app_data, Clay_BoundingBox box, Clay_Color color) {
+    float originX, originY;
+    TreeOrigin(app_data, box, &originX, &originY);
+    float min_x_pos = ((float)batch->clip.x - NODE_RADIUS - originX) / HORIZONTAL_SCALE;
+    float max_x_pos = ((float)(batch->clip.x + batch->clip.w) + NODE_RADIUS - originX) / HORIZONTAL_SCALE;
+    int min_level = max_int((int)ceilf(((float)batch->clip.y - NODE_RADIUS - originY) / VERTICAL_SPACING), 0);
+    int max_level = min_int((int)floorf(((float)(batch->clip.y + batch->clip.h) + NODE_RADIUS - originY) / VERTICAL_SPACING),
+                            app_data->index->num_levels - 1);
+
+    SDL_SetRenderDrawColor(batch->renderer, (Uint8)color.r, (Uint8)color.g, (Uint8)color.b, (Uint8)color.a);
+    for (int level = min_level; level <= max_level; level++) {
+        struct tree_index_entry_t *begin, *end;
+        tree_index_level_range(app_data->index, level, min_x_pos, max_x_pos, &begin, &end);
+        for (struct tree_index_entry_t* entry = begin; entry < end; entry++) {
+            if (!ColorsEqual(NodeColor(app_data, entry), color)) {
+                continue;
+            }
+            float x = (float)entry->x_pos * HORIZONTAL_SCALE + originX;
+            float y = (float)level * VERTICAL_SPACING + originY;
+            batch->batch[batch->batch_size++] = (SDL_Rect) {
+                (int)(x - NODE_RADIUS), (int)(y - NODE_RADIUS), (int)(NODE_RADIUS * 2), (int)(NODE_RADIUS * 2)
+            };
+            if (batch->batch_size == SDL_NODE_BATCH_SIZE) {
+                FlushNodeBatch(batch);
+            }
+        }
+    }
+    FlushNodeBatch(batch);
+}
+
+// The cheaper draw path for trees above the Clay node cap, nodes are drawn as
+// squares straight to the renderer inside the TreeDisplay element
+void RenderTreeSDL(SDL_Renderer* renderer, app_data_t* app_data) {
+    Clay_BoundingBox box;
+    if (!GetTreeDisplayBox(&box) || app_data->index == NULL) {
+        return;
+    }
+    const int border_width = 4;
+
+    static sdl_tree_batch_t batch;
+    batch.renderer = renderer;
+    batch.batch_size = 0;
+    batch.clip = (SDL_Rect) {
+        (int)box.x + border_width, (int)box.y + border_width,
+        (int)box.width - 2 * border_width, (int)box.height - 2 * border_width
+    };
+
+    SDL_RenderSetClipRect(renderer, &batch.clip);
+    DrawVisibleNodesSDL(&batch, app_data, box, nodeColor);
+    DrawVisibleNodesSDL(&batch, app_data, box, selectedColor);
+    DrawVisibleNodesSDL(&batch, app_data, box, hoveredColor);
+    SDL_RenderSetClipRect(renderer, NULL);
+}
+
+bool PointInTreeDisplay(float x, float y) {
+    Clay_BoundingBox box;
+    return GetTreeDisplayBox(&box) &&
+           x >= box.x && x < box.x + box.width && y >= box.y && y < box.y + box.height;
+}
+
+// Nodes are clipped to the TreeDisplay, so only points inside it can hit one
+struct tree_index_entry_t* FindNodeAt(app_data_t* app_data, float x, float y) {
+    Clay_BoundingBox box;
+    if (app_data->index == NULL || !GetTreeDisplayBox(&box) || !PointInTreeDisplay(x, y)) {
+        return NULL;
+    }
+    float x_pos, y_pos;
+    ScreenToLayout(app_data, box, x, y, &x_pos, &y_pos);
+    return tree_index_find(app_data->index, x_pos, y_pos,
+                           NODE_RADIUS / HORIZONTAL_SCALE, NODE_RADIUS / VERTICAL_SPACING);
+}
+
+void SelectEntry(struct tree_index_entry_t* entry, void* data) {
+    entry->selected = true;
+}
+
+// Drags shorter than this are treated as clicks
+#define DRAG_THRESHOLD 4.0f
+
+bool IsRubberBand(app_data_t* app_data) {
+    return app_data->dragging &&
+           (fabsf(app_data->drag_x - app_data->drag_start_x) > DRAG_THRESHOLD ||
+            fabsf(app_data->drag_y - app_data->drag_start_y) > DRAG_THRESHOLD);
+}
+
+// Click selects the node under the mouse and a drag selects every node in the
+// rubber band, holding shift adds to the selection instead of replacing it
+void FinishSelection(app_data_t* app_data) {
+    Clay_BoundingBox box;
+    if (app_data->index == NULL || !GetTreeDisplayBox(&box)) {
+        return;
+    }
+    bool extend = (SDL_GetModState() & KMOD_SHIFT) != 0;
+    struct tree_index_entry_t* clicked = IsRubberBand(app_data) ? NULL : FindNodeAt(app_data, app_data->drag_x, app_data->drag_y);
+    bool was_selected = clicked && clicked->selected;
+    if (!extend) {
+        tree_index_clear_selection(app_data->index);
+    }
+
+    if (IsRubberBand(app_data)) {
+        float x0, y0, x1, y1;
+        ScreenToLayout(app_data, box, fminf(app_data->drag_start_x, app_data->drag_x),
+                       fminf(app_data->drag_start_y, app_data->drag_y), &x0, &y0);
+        ScreenToLayout(app_data, box, fmaxf(app_data->drag_start_x, app_data->drag_x),
+                       fmaxf(app_data->drag_start_y, app_data->drag_y), &x1, &y1);
+        tree_index_query_rect(app_data->index, x0, y0, x1, y1, SelectEntry, NULL);
+    } else if (clicked) {
+        clicked->selected = !(extend && was_selected);
+    }
+}
+
+void RenderRubberBand(SDL_Renderer* renderer, app_data_t* app_data) {
+    if (!IsRubberBand(app_data)) {
+        return;
+    }
+    SDL_Rect band = {
+        (int)fminf(app_data->drag_start_x, app_data->drag_x), (int)fminf(app_data->drag_start_y, app_data->drag_y),
+        (int)fabsf(app_data->drag_x - app_data->drag_start_x), (int)fabsf(app_data->drag_y - app_data->drag_start_y)
+    };
+    SDL_SetRenderDrawColor(renderer, (Uint8)selectedColor.r, (Uint8)selectedColor.g, (Uint8)selectedColor.b, 60);
+    SDL_RenderFillRect(renderer, &band);
+    SDL_SetRenderDrawColor(renderer, (Uint8)selectedColor.r, (Uint8)selectedColor.g, (Uint8)selectedColor.b, 255);
+    SDL_RenderDrawRect(renderer, &band);
+}
+
+// Command line options, the random tree options apply to both the viewer and
+// rendering a tree to files
+typedef struct {
+    const char* svg_path;
+    const char* png_prefix;
+    float png_scale;
+    int png_width;
+    int min_height;
+    int max_height;
+    float chance_to_continue;
+    int num_threads;
+    int clay_node_cap;
+} options_t;
+
+bool ParseOptions(int argc, char *argv[], options_t* options) {
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--svg") == 0 && has_value) {
+            options->svg_path = argv[++i];
+        } else if (strcmp(argv[i], "--png") == 0 && has_value) {
+            options->png_prefix = argv[++i];
+        } else if (strcmp(argv[i], "--png-scale") == 0 && has_value) {
+            options->png_scale = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--png-width") == 0 && has_value) {
+            options->png_width = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--min-height") == 0 && has_value) {
+            options->min_height = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max-height") == 0 && has_value) {
+            options->max_height = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--chance") == 0 && has_value) {
+            options->chance_to_continue = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && has_value) {
+            options->num_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--clay-node-cap") == 0 && has_value) {
+            options->clay_node_cap = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [--svg <file>] [--png <prefix>] [--png-scale <s>] [--png-width <px>] [--min-height <n>] [--max-height <n>] "
+                            "[--chance <p>] [--threads <n>] [--clay-node-cap <n>]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+int RunHeadless(options_t* options) {
+    struct tree_t* tree = tree_random(options->min_height, options->max_height, options->chance_to_continue);
+    tree_compute_layout(tree);
+
+    int status = 0;
+    if (options->svg_path) {
+        FILE* out = fopen(options->svg_path, "w");
+        if (!out) {
+            fprintf(stderr, "Error: could not open %s\n", options->svg_path);
+            status = 1;
+        } else {
+            // a large buffer keeps the streamed writes from dominating the export
+            setvbuf(out, NULL, _IOFBF, 1 << 20);
+            if (!tree_export_svg(tree, out)) {
+                fprintf(stderr, "Error: could not write %s\n", options->svg_path);
+                status = 1;
+            }
+            fclose(out);
+        }
+    }
+    if (options->png_prefix) {
+        // --png-scale scales the viewer's spacing, --png-width squeezes the
+        // tree horizontally to fit so very wide trees stay a few tiles
+        float x_scale = HORIZONTAL_SCALE * options->png_scale;
+        float y_scale = VERTICAL_SPACING * options->png_scale;
+        if (options->png_width > 0) {
+            x_scale = fminf(x_scale, tree_fit_x_scale(tree, options->png_width));
+        }
+        if (!tree_export_png_tiles(tree, options->png_prefix, x_scale, y_scale, options->num_threads)) {
+            status = 1;
+        }
+    }
+
+    tree_free(tree);
+    return status;
+}
+
 int main(int argc, char *argv[]) {
+    options_t options = {
+        .png_scale = 1.0f,
+        .min_height = 3,
+        .max_height = 7,
+        .chance_to_continue = 0.4f,
+        .num_threads = 0,
+        .clay_node_cap = DEFAULT_CLAY_NODE_CAP,
+    };
+    if (!ParseOptions(argc, argv, &options)) {
+        return 1;
+    }
+    if (options.svg_path || options.png_prefix) {
+        return RunHeadless(&options);
+    }
+
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
         fprintf(stderr, "Error: could not initialize SDL: %s\n", SDL_GetError());
         return 1;
@@ -120,12 +473,15 @@ int main(int argc, char *argv[]) {
     SDL_Renderer *renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
 
-    uint64_t totalMemorySize = Clay_MinMemorySize();
-    Clay_Arena clayMemory = Clay_CreateArenaWithCapacityAndMemory(totalMemorySize, malloc(totalMemorySize));
-
-    Clay_Initialize(clayMemory, (Clay_Dimensions) { (float)windowWidth, (float)windowHeight }, (Clay_ErrorHandler) { HandleClayErrors });
-
-    app_data_t app_data = { 0 };
+    app_data_t app_data = { .clay_node_cap = options.clay_node_cap };
+    ResizeClayArena(&app_data, (Clay_Dimensions) { (float)windowWidth, (float)windowHeight });
+    if (!app_data.clay_memory) {
+        // without an arena there is no Clay context to lay the UI out in
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 1;
+    }
 
     bool running = true;
 
@@ -145,18 +501,51 @@ int main(int argc, char *argv[]) {
                 case SDL_KEYDOWN:
                     if (event.key.keysym.sym == SDLK_SPACE) {
                         tree_free(app_data.tree);
-                        const int min_height = 3;
-                        const int max_height = 7;
-                        const float chance_to_continue = 0.4f;
-                        app_data.tree = tree_random(min_height, max_height, chance_to_continue);
+                        app_data.tree = tree_random(options.min_height, options.max_height, options.chance_to_continue);
                         tree_compute_layout(app_data.tree);
-
-                        char* tree_str = tree_to_string(app_data.tree);
-                        if (tree_str) {
-                            printf("%s\n", tree_str);
+                        app_data.num_nodes = tree_count_nodes(app_data.tree);
+                        UpdateTreeIndex(&app_data);
+                        ResizeClayArena(&app_data, (Clay_Dimensions) { (float)windowWidth, (float)windowHeight });
+
+                        // the dump of a tree too big for Clay is hundreds of MB and
+                        // would stall the UI for seconds
+                        if (TreeDrawnWithClay(&app_data)) {
+                            char* tree_str = tree_to_string(app_data.tree);
+                            if (tree_str) {
+                                printf("%s\n", tree_str);
+                            }
+                            free(tree_str);
                         }
-                        free(tree_str);
                     }
+                    break;
+                case SDL_WINDOWEVENT:
+                    if (event.window.event == SDL_WINDOWEVENT_LEAVE) {
+                        app_data.mouse_in_window = false;
+                    } else if (event.window.event == SDL_WINDOWEVENT_ENTER) {
+                        app_data.mouse_in_window = true;
+                    }
+                    break;
+                case SDL_MOUSEMOTION:
+                    app_data.mouse_in_window = true;
+                    app_data.mouse_x = app_data.drag_x = (float)event.motion.x;
+                    app_data.mouse_y = app_data.drag_y = (float)event.motion.y;
+                    break;
+                case SDL_MOUSEBUTTONDOWN:
+                    if (event.button.button == SDL_BUTTON_LEFT &&
+                        PointInTreeDisplay((float)event.button.x, (float)event.button.y)) {
+                        app_data.dragging = true;
+                        app_data.drag_start_x = app_data.drag_x = (float)event.button.x;
+                        app_data.drag_start_y = app_data.drag_y = (float)event.button.y;
+                    }
+                    break;
+                case SDL_MOUSEBUTTONUP:
+                    if (event.button.button == SDL_BUTTON_LEFT && app_data.dragging) {
+                        app_data.drag_x = (float)event.button.x;
+                        app_data.drag_y = (float)event.button.y;
+                        FinishSelection(&app_data);
+                        app_data.dragging = false;
+                    }
+                    break;
                 default:
                     break;
             }
@@ -176,6 +565,8 @@ int main(int argc, char *argv[]) {
             app_data.x_offset += 0.1f;
         }
 
+        app_data.hovered = app_data.mouse_in_window ? FindNodeAt(&app_data, app_data.mouse_x, app_data.mouse_y) : NULL;
+
         SDL_GetWindowSize(window, &windowWidth, &windowHeight);
         Clay_SetLayoutDimensions((Clay_Dimensions) { (float)windowWidth, (float)windowHeight });
 
@@ -185,6 +576,10 @@ int main(int argc, char *argv[]) {
         SDL_RenderClear(renderer);
 
         Clay_SDL2_Render(renderer, renderCommands, NULL);
+        if (app_data.tree != NULL && !TreeDrawnWithClay(&app_data)) {
+            RenderTreeSDL(renderer, &app_data);
+        }
+        RenderRubberBand(renderer, &app_data);
 
         SDL_RenderPresent(renderer);
 
@@ -194,7 +589,9 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    tree_index_free(app_data.index);
     tree_free(app_data.tree);
+    free(app_data.clay_memory);
 
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
@@ -0,0 +1,174 @@
+#include "tree_index.h"
+#include "utils.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+static void count_levels(struct tree_t* tree, int* level_start) {
+    if (!tree) {
+        return;
+    }
+    level_start[tree->y_pos + 1]++;
+    count_levels(tree->left_child, level_start);
+    count_levels(tree->right_child, level_start);
+}
+
+// A preorder walk reaches the nodes of a level from left to right, so every
+// level comes out sorted without a sort
+static void fill_levels(struct tree_t* tree, struct tree_index_entry_t* entries, int* level_next) {
+    if (!tree) {
+        return;
+    }
+    entries[level_next[tree->y_pos]++] = (struct tree_index_entry_t) {
+        .x_pos = tree->x_pos,
+        .selected = false,
+        .node = tree,
+    };
+    fill_levels(tree->left_child, entries, level_next);
+    fill_levels(tree->right_child, entries, level_next);
+}
+
+struct tree_index_t* tree_index_build(struct tree_t* tree) {
+    struct tree_index_t* index = malloc(sizeof(struct tree_index_t));
+    if (!index) {
+        return NULL;
+    }
+    *index = (struct tree_index_t) {
+        .num_levels = tree_height(tree),
+        .num_entries = tree_count_nodes(tree),
+    };
+    index->entries = malloc(sizeof(struct tree_index_entry_t) * (size_t)max_int(index->num_entries, 1));
+    index->level_start = calloc((size_t)index->num_levels + 1, sizeof(int));
+    int* level_next = malloc(sizeof(int) * (size_t)max_int(index->num_levels, 1));
+    if (!index->entries || !index->level_start || !level_next) {
+        free(level_next);
+        tree_index_free(index);
+        return NULL;
+    }
+
+    count_levels(tree, index->level_start);
+    for (int level = 0; level < index->num_levels; level++) {
+        index->level_start[level + 1] += index->level_start[level];
+        level_next[level] = index->level_start[level];
+    }
+    fill_levels(tree, index->entries, level_next);
+    free(level_next);
+
+    for (int level = 0; level < index->num_levels; level++) {
+        for (int i = index->level_start[level] + 1; i < index->level_start[level + 1]; i++) {
+            assert(index->entries[i - 1].x_pos < index->entries[i].x_pos);
+        }
+    }
+    return index;
+}
+
+void tree_index_free(struct tree_index_t* index) {
+    if (index != NULL) {
+        free(index->entries);
+        free(index->level_start);
+        free(index);
+    }
+}
+
+static int compare_ids(const void* a, const void* b) {
+    int left = *(const int*)a, right = *(const int*)b;
+    return (left > right) - (left < right);
+}
+
+void tree_index_copy_selection(struct tree_index_t* to, struct tree_index_t* from) {
+    int num_selected = 0;
+    for (int i = 0; i < from->num_entries; i++) {
+        num_selected += from->entries[i].selected;
+    }
+    if (num_selected == 0) {
+        return;
+    }
+    int* selected_ids = malloc(sizeof(int) * (size_t)num_selected);
+    if (!selected_ids) {
+        return;
+    }
+    num_selected = 0;
+    for (int i = 0; i < from->num_entries; i++) {
+        if (from->entries[i].selected) {
+            selected_ids[num_selected++] = from->entries[i].node->id;
+        }
+    }
+    qsort(selected_ids, (size_t)num_selected, sizeof(int), compare_ids);
+    for (int i = 0; i < to->num_entries; i++) {
+        int id = to->entries[i].node->id;
+        to->entries[i].selected = bsearch(&id, selected_ids, (size_t)num_selected, sizeof(int), compare_ids) != NULL;
+    }
+    free(selected_ids);
+}
+
+void tree_index_clear_selection(struct tree_index_t* index) {
+    for (int i = 0; i < index->num_entries; i++) {
+        index->entries[i].selected = false;
+    }
+}
+
+// The first entry in [begin, end) with x_pos >= x_pos, or > x_pos when inclusive is false
+static struct tree_index_entry_t* lower_bound(struct tree_index_entry_t* begin, struct tree_index_entry_t* end,
+                                              float x_pos, bool inclusive) {
+    while (begin < end) {
+        struct tree_index_entry_t* middle = begin + (end - begin) / 2;
+        bool before = inclusive ? (float)middle->x_pos < x_pos : (float)middle->x_pos <= x_pos;
+        if (before) {
+            begin = middle + 1;
+        } else {
+            end = middle;
+        }
+    }
+    return begin;
+}
+
+void tree_index_level_range(struct tree_index_t* index, int level, float min_x_pos, float max_x_pos,
+                            struct tree_index_entry_t** begin, struct tree_index_entry_t** end) {
+    if (level < 0 || level >= index->num_levels || min_x_pos > max_x_pos) {
+        *begin = *end = index->entries;
+        return;
+    }
+    struct tree_index_entry_t* level_begin = index->entries + index->level_start[level];
+    struct tree_index_entry_t* level_end = index->entries + index->level_start[level + 1];
+    *begin = lower_bound(level_begin, level_end, min_x_pos, true);
+    *end = lower_bound(*begin, level_end, max_x_pos, false);
+}
+
+struct tree_index_entry_t* tree_index_find(struct tree_index_t* index, float x_pos, float y_pos,
+                                           float x_radius, float y_radius) {
+    struct tree_index_entry_t* closest = NULL;
+    float closest_distance = 1.0f;
+    int min_level = max_int((int)ceilf(y_pos - y_radius), 0);
+    int max_level = min_int((int)floorf(y_pos + y_radius), index->num_levels - 1);
+    for (int level = min_level; level <= max_level; level++) {
+        struct tree_index_entry_t *begin, *end;
+        tree_index_level_range(index, level, x_pos - x_radius, x_pos + x_radius, &begin, &end);
+        for (struct tree_index_entry_t* entry = begin; entry < end; entry++) {
+            float dx = ((float)entry->x_pos - x_pos) / x_radius;
+            float dy = ((float)level - y_pos) / y_radius;
+            float distance = dx * dx + dy * dy;
+            if (distance <= closest_distance) {
+                closest = entry;
+                closest_distance = distance;
+            }
+        }
+    }
+    return closest;
+}
+
+int tree_index_query_rect(struct tree_index_t* index, float min_x_pos, float min_y_pos,
+                          float max_x_pos, float max_y_pos,
+                          void (*visit)(struct tree_index_entry_t* entry, void* data), void* data) {
+    int count = 0;
+    int min_level = max_int((int)ceilf(min_y_pos), 0);
+    int max_level = min_int((int)floorf(max_y_pos), index->num_levels - 1);
+    for (int level = min_level; level <= max_level; level++) {
+        struct tree_index_entry_t *begin, *end;
+        tree_index_level_range(index, level, min_x_pos, max_x_pos, &begin, &end);
+        for (struct tree_index_entry_t* entry = begin; entry < end; entry++) {
+            visit(entry, data);
+        }
+        count += (int)(end - begin);
+    }
+    return count;
+}
@@ -0,0 +1,48 @@
+#ifndef TIDIER_TREES_TREE_INDEX_H
+#define TIDIER_TREES_TREE_INDEX_H
+
+#include <stdbool.h>
+
+#include "trees.h"
+
+struct tree_index_entry_t {
+    int x_pos;
+    bool selected;
+    struct tree_t* node;
+};
+
+// A spatial index of a laid out tree. Since y_pos is the depth of a node, the
+// entries are grouped by level and each level is sorted by x_pos, so lookups
+// are a binary search within the levels they cover
+struct tree_index_t {
+    struct tree_index_entry_t* entries;
+    int* level_start; // level i holds entries [level_start[i], level_start[i + 1])
+    int num_levels;
+    int num_entries;
+};
+
+// Builds the index from the current layout, returns NULL if allocation fails.
+// The index has to be rebuilt whenever the tree is laid out again
+struct tree_index_t* tree_index_build(struct tree_t* tree);
+void tree_index_free(struct tree_index_t* index);
+
+// Selects the entries of to whose node ids were selected in from, so the
+// selection survives rebuilding the index after a relayout
+void tree_index_copy_selection(struct tree_index_t* to, struct tree_index_t* from);
+void tree_index_clear_selection(struct tree_index_t* index);
+
+// The entries of a level with min_x_pos <= x_pos <= max_x_pos, as [*begin, *end)
+void tree_index_level_range(struct tree_index_t* index, int level, float min_x_pos, float max_x_pos,
+                            struct tree_index_entry_t** begin, struct tree_index_entry_t** end);
+
+// The entry whose node, drawn as an ellipse with the given radii in layout
+// units, contains the point, or NULL
+struct tree_index_entry_t* tree_index_find(struct tree_index_t* index, float x_pos, float y_pos,
+                                           float x_radius, float y_radius);
+
+// Calls visit on every entry inside the rectangle and returns how many there were
+int tree_index_query_rect(struct tree_index_t* index, float min_x_pos, float min_y_pos,
+                          float max_x_pos, float max_y_pos,
+                          void (*visit)(struct tree_index_entry_t* entry, void* data), void* data);
+
+#endif //TIDIER_TREES_TREE_INDEX_H
@@ -1,22 +1,100 @@
 #include "trees.h"
 #include "utils.h"
 #include <assert.h>
+#include <limits.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+// Shared by every thread, pools take whole ranges of ids from it at once
+static atomic_int next_tree_id = 0;
+
+// Reserves count ids, atomic ints wrap on overflow so running out shows up as
+// a negative or too large first id
+static int reserve_tree_ids(int count) {
+    int first = atomic_fetch_add_explicit(&next_tree_id, count, memory_order_relaxed);
+    assert(first >= 0 && first <= INT_MAX - count && "tree node ids exhausted");
+    return first;
+}
+
 struct tree_t* new_tree_node(void) {
-    static int next_tree_id = 0;
     struct tree_t* tree = (struct tree_t*) malloc(sizeof(struct tree_t));
     *tree = (struct tree_t){
         .left_child = NULL,
         .right_child = NULL,
-        .id = next_tree_id++
+        .id = reserve_tree_ids(1)
+    };
+    return tree;
+}
+
+struct tree_pool_chunk_t {
+    struct tree_pool_chunk_t* next;
+    struct tree_t nodes[TREE_POOL_CHUNK_SIZE];
+};
+
+void tree_pool_init(struct tree_pool_t* pool) {
+    *pool = (struct tree_pool_t){ 0 };
+}
+
+struct tree_t* tree_pool_new_node(struct tree_pool_t* pool) {
+    if (!pool->chunks || pool->chunk_used == TREE_POOL_CHUNK_SIZE) {
+        struct tree_pool_chunk_t* chunk = malloc(sizeof(struct tree_pool_chunk_t));
+        if (!chunk) {
+            return NULL;
+        }
+        chunk->next = pool->chunks;
+        pool->chunks = chunk;
+        pool->chunk_used = 0;
+        if (!pool->last_chunk) {
+            pool->last_chunk = chunk;
+        }
+    }
+    if (pool->next_id == pool->end_id) {
+        // small pools only waste a few ids, busy ones soon take full ranges
+        pool->id_range = pool->id_range ? min_int(pool->id_range * 2, TREE_POOL_ID_RANGE) : TREE_POOL_MIN_ID_RANGE;
+        pool->next_id = reserve_tree_ids(pool->id_range);
+        pool->end_id = pool->next_id + pool->id_range;
+    }
+    struct tree_t* tree = &pool->chunks->nodes[pool->chunk_used++];
+    *tree = (struct tree_t){
+        .left_child = NULL,
+        .right_child = NULL,
+        .id = pool->next_id++
     };
     return tree;
 }
 
+void tree_pool_merge(struct tree_pool_t* into, struct tree_pool_t* from) {
+    if (!from->chunks) {
+        return;
+    }
+    if (!into->chunks) {
+        into->chunks = from->chunks;
+        into->last_chunk = from->last_chunk;
+        into->chunk_used = from->chunk_used;
+    } else {
+        // into keeps allocating from its newest chunk, the full chunks of from go behind it
+        from->last_chunk->next = into->chunks->next;
+        if (into->last_chunk == into->chunks) {
+            into->last_chunk = from->last_chunk;
+        }
+        into->chunks->next = from->chunks;
+    }
+    tree_pool_init(from);
+}
+
+void tree_pool_free(struct tree_pool_t* pool) {
+    struct tree_pool_chunk_t* chunk = pool->chunks;
+    while (chunk) {
+        struct tree_pool_chunk_t* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    tree_pool_init(pool);
+}
+
 struct tree_t* tree_random(int min_height, int max_height, float chance_to_continue) {
     if (max_height == 0) {
         return NULL;
@@ -67,6 +145,133 @@ void tree_free(struct tree_t* tree) {
     }
 }
 
+int tree_count_nodes(struct tree_t* tree) {
+    if (!tree) {
+        return 0;
+    }
+    return 1 + tree_count_nodes(tree->left_child) + tree_count_nodes(tree->right_child);
+}
+
+int tree_height(struct tree_t *tree) {
+    if (!tree) {
+        return 0;
+    }
+    return 1 + max_int(tree_height(tree->left_child), tree_height(tree->right_child));
+}
+
+// Copies a node into the next free slot of the block, its children still point
+// at the source tree until they are copied too
+static struct tree_t* relayout_emit(struct tree_t* source, struct tree_block_t* block) {
+    struct tree_t* node = &block->nodes[block->num_nodes++];
+    *node = *source;
+    return node;
+}
+
+static struct tree_t* relayout_preorder(struct tree_t* source, struct tree_block_t* block) {
+    if (!source) {
+        return NULL;
+    }
+    struct tree_t* node = relayout_emit(source, block);
+    node->left_child = relayout_preorder(source->left_child, block);
+    node->right_child = relayout_preorder(source->right_child, block);
+    return node;
+}
+
+static struct tree_t* relayout_postorder(struct tree_t* source, struct tree_block_t* block) {
+    if (!source) {
+        return NULL;
+    }
+    struct tree_t* left_child = relayout_postorder(source->left_child, block);
+    struct tree_t* right_child = relayout_postorder(source->right_child, block);
+    struct tree_t* node = relayout_emit(source, block);
+    node->left_child = left_child;
+    node->right_child = right_child;
+    return node;
+}
+
+// The block doubles as the bfs queue, nodes between head and num_nodes have
+// been copied but still point at their children in the source tree
+static struct tree_t* relayout_bfs(struct tree_t* source, struct tree_block_t* block) {
+    if (!source) {
+        return NULL;
+    }
+    relayout_emit(source, block);
+    for (int head = 0; head < block->num_nodes; head++) {
+        struct tree_t* node = &block->nodes[head];
+        if (node->left_child) {
+            node->left_child = relayout_emit(node->left_child, block);
+        }
+        if (node->right_child) {
+            node->right_child = relayout_emit(node->right_child, block);
+        }
+    }
+    return &block->nodes[0];
+}
+
+static void relayout_van_emde_boas(struct tree_t** slot, int height, struct tree_block_t* block);
+
+// Lays out the bottom subtrees hanging below depth levels of an already copied top tree
+static void relayout_van_emde_boas_bottoms(struct tree_t* node, int depth, int height, struct tree_block_t* block) {
+    if (!node) {
+        return;
+    }
+    if (depth == 0) {
+        relayout_van_emde_boas(&node->left_child, height, block);
+        relayout_van_emde_boas(&node->right_child, height, block);
+    } else {
+        relayout_van_emde_boas_bottoms(node->left_child, depth - 1, height, block);
+        relayout_van_emde_boas_bottoms(node->right_child, depth - 1, height, block);
+    }
+}
+
+// Copies the top height levels of the subtree in *slot, replacing *slot with the copy
+static void relayout_van_emde_boas(struct tree_t** slot, int height, struct tree_block_t* block) {
+    if (!*slot) {
+        return;
+    }
+    if (height == 1) {
+        *slot = relayout_emit(*slot, block);
+        return;
+    }
+    const int top_height = height / 2;
+    relayout_van_emde_boas(slot, top_height, block);
+    relayout_van_emde_boas_bottoms(*slot, top_height - 1, height - top_height, block);
+}
+
+struct tree_block_t tree_relayout_memory(struct tree_t* tree, enum tree_order_t order) {
+    struct tree_block_t block = { 0 };
+    const int num_nodes = tree_count_nodes(tree);
+    if (num_nodes == 0) {
+        return block;
+    }
+    block.nodes = malloc(sizeof(struct tree_t) * (size_t)num_nodes);
+    if (!block.nodes) {
+        return block;
+    }
+    switch (order) {
+        case TREE_ORDER_PREORDER:
+            block.root = relayout_preorder(tree, &block);
+            break;
+        case TREE_ORDER_POSTORDER:
+            block.root = relayout_postorder(tree, &block);
+            break;
+        case TREE_ORDER_BFS:
+            block.root = relayout_bfs(tree, &block);
+            break;
+        case TREE_ORDER_VAN_EMDE_BOAS:
+            block.root = tree;
+            relayout_van_emde_boas(&block.root, tree_height(tree), &block);
+            break;
+    }
+    assert(block.num_nodes == num_nodes);
+    return block;
+}
+
+void tree_block_free(struct tree_block_t* block) {
+    free(block->nodes);
+    *block = (struct tree_block_t){ 0 };
+}
+
 // An internal tree struct that repurposes the space of the tree to calculate tree
 // layout without memory allocations
 struct tree_internal_t {
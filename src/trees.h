@@ -10,9 +10,62 @@ struct tree_t {
 struct tree_t* tree_random(int min_height, int max_height, float chance_to_continue);
 struct tree_t* tree_copy(struct tree_t *tree);
 void tree_free(struct tree_t* tree);
+int tree_count_nodes(struct tree_t* tree);
+int tree_height(struct tree_t* tree);
 void tree_compute_layout(struct tree_t* tree);
 char* tree_to_string(struct tree_t* tree);
 
+// Allocates nodes for one thread at a time, so trees can be built concurrently
+// with a pool per thread. Ids come from ranges reserved with a single atomic
+// add, starting at TREE_POOL_MIN_ID_RANGE and doubling up to TREE_POOL_ID_RANGE,
+// and nodes from chunks of TREE_POOL_CHUNK_SIZE.
+// Pool nodes are freed with their pool rather than with tree_free
+//
+// Unused ids of a merged or freed pool are lost, at most as many as the pool
+// used plus TREE_POOL_MIN_ID_RANGE. Ids are ints shared with new_tree_node, so
+// a process runs out after about 2^31 nodes or 2^31 / TREE_POOL_MIN_ID_RANGE
+// pools, which is asserted rather than wrapped into duplicate ids
+#define TREE_POOL_MIN_ID_RANGE 16
+#define TREE_POOL_ID_RANGE 4096
+#define TREE_POOL_CHUNK_SIZE 4096
+
+struct tree_pool_chunk_t;
+
+struct tree_pool_t {
+    struct tree_pool_chunk_t *chunks, *last_chunk; // newest chunk first
+    int chunk_used;
+    int next_id, end_id, id_range;
+};
+
+void tree_pool_init(struct tree_pool_t* pool);
+struct tree_t* tree_pool_new_node(struct tree_pool_t* pool);
+// Moves the nodes of from into into without copying them, so subtrees built
+// on other threads can be linked into one tree, from is left empty
+void tree_pool_merge(struct tree_pool_t* into, struct tree_pool_t* from);
+void tree_pool_free(struct tree_pool_t* pool);
+
+// Orders that tree_relayout_memory can place nodes in
+enum tree_order_t {
+    TREE_ORDER_PREORDER,
+    TREE_ORDER_POSTORDER,
+    TREE_ORDER_BFS,
+    // recursively splits the tree at half its height, so that every subtree of
+    // height 2^k is contiguous no matter the cache line or page size
+    TREE_ORDER_VAN_EMDE_BOAS,
+};
+
+// A tree whose nodes all live in one allocation, root points into nodes
+struct tree_block_t {
+    struct tree_t* root;
+    struct tree_t* nodes;
+    int num_nodes;
+};
+
+// Copies the tree into one contiguous block in the given order, nodes is NULL
+// if the allocation fails. Free with tree_block_free rather than tree_free
+struct tree_block_t tree_relayout_memory(struct tree_t* tree, enum tree_order_t order);
+void tree_block_free(struct tree_block_t* block);
+
 // Definitions that configures compute_layout
 #define MINIMUM_NODE_OFFSET 2
 
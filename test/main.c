@@ -5,8 +5,11 @@
 #include <setjmp.h>
 #include <cmocka.h>
 #include <stdint.h>
+#include <pthread.h>
 
 #include "trees.c"
+#include "export.h"
+#include "tree_index.h"
 
 bool tree_value_equal(struct tree_t *tree, struct tree_t *other) {
     if (!tree || !other) {
@@ -17,13 +20,6 @@ bool tree_value_equal(struct tree_t *tree, struct tree_t *other) {
         && tree_value_equal(tree->right_child, other->right_child);
 }
 
-int tree_height(struct tree_t *tree) {
-    if (!tree) {
-        return 0;
-    }
-    return 1 + max_int(tree_height(tree->left_child), tree_height(tree->right_child));
-}
-
 struct tree_t* trees[] = {&singleton_tree, &left_leaning_tree, &right_leaning_tree, &broken_contour_tree};
 int num_trees = sizeof(trees) / sizeof(trees[0]);
 
@@ -155,6 +151,489 @@ static void test_compute_layout_of_random_tree_has_same_length_contour(void **st
     }
 }
 
+static int count_occurrences(const char* haystack, const char* needle) {
+    int count = 0;
+    for (const char* found = strstr(haystack, needle); found; found = strstr(found + 1, needle)) {
+        count++;
+    }
+    return count;
+}
+
+static void test_export_svg_writes_every_node_and_edge(void **state) {
+    const int random_tree_tests = 100;
+    for (int i = 0; i < random_tree_tests; i++) {
+        struct tree_t* tree = tree_random(1, 8, 0.4f);
+        tree_compute_layout(tree);
+        const int num_nodes = tree_count_nodes(tree);
+
+        FILE* out = tmpfile();
+        assert_non_null(out);
+        assert_true(tree_export_svg(tree, out));
+        long length = ftell(out);
+        rewind(out);
+        char* svg = calloc((size_t)length + 1, 1);
+        assert_int_equal(fread(svg, 1, (size_t)length, out), length);
+        fclose(out);
+
+        assert_int_equal(count_occurrences(svg, "<circle"), num_nodes);
+        assert_int_equal(count_occurrences(svg, "<line"), num_nodes - 1);
+        free(svg);
+        tree_free(tree);
+    }
+}
+
+static bool tree_inside_bounds(struct tree_t *tree, struct tree_bounds_t *bounds) {
+    if (!tree) {
+        return true;
+    }
+    return tree->x_pos >= bounds->min_x_pos && tree->x_pos <= bounds->max_x_pos && tree->y_pos <= bounds->max_y_pos &&
+        tree_inside_bounds(tree->left_child, bounds) && tree_inside_bounds(tree->right_child, bounds);
+}
+
+static void test_tree_bounds_contain_every_node(void **state) {
+    const int random_tree_tests = 100;
+    for (int i = 0; i < random_tree_tests; i++) {
+        struct tree_t* tree = tree_random(3, 8, 0.4f);
+        tree_compute_layout(tree);
+        struct tree_bounds_t bounds = tree_bounds(tree, HORIZONTAL_SCALE, VERTICAL_SPACING);
+        assert_true(tree_inside_bounds(tree, &bounds));
+        assert_int_equal(bounds.max_y_pos, tree_height(tree) - 1);
+        assert_int_equal(bounds.node_radius, (int)NODE_RADIUS);
+        assert_int_equal(bounds.margin, EXPORT_MARGIN);
+        assert_int_equal(bounds.width,
+                         (int)((float)(bounds.max_x_pos - bounds.min_x_pos) * HORIZONTAL_SCALE) + 2 * EXPORT_MARGIN);
+        assert_int_equal(bounds.height, (int)((float)bounds.max_y_pos * VERTICAL_SPACING) + 2 * EXPORT_MARGIN);
+
+        // the node radius and margin follow the smaller of the two scales
+        struct tree_bounds_t half = tree_bounds(tree, HORIZONTAL_SCALE / 2, VERTICAL_SPACING);
+        assert_int_equal(half.node_radius, (int)NODE_RADIUS / 2);
+        assert_int_equal(half.margin, EXPORT_MARGIN / 2);
+        assert_int_equal(half.width,
+                         (int)((float)(half.max_x_pos - half.min_x_pos) * HORIZONTAL_SCALE / 2) + EXPORT_MARGIN);
+        assert_int_equal(half.height, (int)((float)half.max_y_pos * VERTICAL_SPACING) + EXPORT_MARGIN);
+        tree_free(tree);
+    }
+}
+
+static int image_x(struct tree_t *tree, struct tree_bounds_t *bounds) {
+    return (int)((float)(tree->x_pos - bounds->min_x_pos) * bounds->x_scale) + bounds->margin;
+}
+
+static int image_y(struct tree_t *tree, struct tree_bounds_t *bounds) {
+    return (int)((float)tree->y_pos * bounds->y_scale) + bounds->margin;
+}
+
+// Checks that every node whose center lands in the raster is drawn there
+static bool raster_has_nodes(struct tree_t *tree, struct tree_raster_t *raster) {
+    if (!tree) {
+        return true;
+    }
+    int x = image_x(tree, &raster->bounds) - raster->x0, y = image_y(tree, &raster->bounds) - raster->y0;
+    bool drawn = x < 0 || x >= raster->width || y < 0 || y >= raster->height ||
+        raster->pixels[y * raster->pitch + x] == EXPORT_NODE_COLOR;
+    return drawn && raster_has_nodes(tree->left_child, raster) && raster_has_nodes(tree->right_child, raster);
+}
+
+static void test_rasterize_draws_nodes_and_edges(void **state) {
+    struct tree_t* tree = tree_random(3, 3, 0.0f);
+    tree_compute_layout(tree);
+    struct tree_raster_t raster = {
+        .bounds = tree_bounds(tree, HORIZONTAL_SCALE, VERTICAL_SPACING),
+        .extents = tree_subtree_extents(tree),
+    };
+    raster.width = raster.pitch = raster.bounds.width;
+    raster.height = raster.bounds.height;
+    raster.pixels = malloc(sizeof(uint32_t) * (size_t)(raster.width * raster.height));
+    tree_rasterize(tree, &raster);
+
+    assert_true(raster_has_nodes(tree, &raster));
+    assert_int_equal(raster.pixels[0], EXPORT_BACKGROUND_COLOR);
+    // halfway between the root and its left child is outside both circles
+    int x0 = image_x(tree, &raster.bounds), x1 = image_x(tree->left_child, &raster.bounds);
+    int y0 = image_y(tree, &raster.bounds), height = image_y(tree->left_child, &raster.bounds) - y0;
+    int mid_x = x0 + (x1 - x0) * (height / 2) / height, mid_y = y0 + height / 2;
+    assert_int_equal(raster.pixels[mid_y * raster.pitch + mid_x], EXPORT_EDGE_COLOR);
+
+    free(raster.pixels);
+    free(raster.extents);
+    tree_free(tree);
+}
+
+static void test_rasterize_tiles_of_a_wide_tree(void **state) {
+    struct tree_t* tree = tree_random(9, 9, 0.0f);
+    tree_compute_layout(tree);
+    struct tree_bounds_t bounds = tree_bounds(tree, HORIZONTAL_SCALE, VERTICAL_SPACING);
+    int rows, columns;
+    tree_tile_grid(&bounds, &rows, &columns);
+    assert_int_equal(rows, 1);
+    assert_int_equal(columns, (bounds.width + EXPORT_TILE_SIZE - 1) / EXPORT_TILE_SIZE);
+    assert_true(columns > 1);
+
+    char path[64];
+    tree_tile_path(path, sizeof(path), "out", 0, columns - 1);
+    char expected[64];
+    snprintf(expected, sizeof(expected), "out_0_%d.png", columns - 1);
+    assert_string_equal(path, expected);
+
+    // the last column is narrower than a full tile and is offset into the image
+    struct tree_raster_t raster = {
+        .x0 = (columns - 1) * EXPORT_TILE_SIZE,
+        .y0 = 0,
+        .bounds = bounds,
+        .extents = tree_subtree_extents(tree),
+    };
+    raster.width = raster.pitch = bounds.width - raster.x0;
+    raster.height = bounds.height;
+    assert_true(raster.width <= EXPORT_TILE_SIZE);
+    raster.pixels = malloc(sizeof(uint32_t) * (size_t)(raster.width * raster.height));
+    tree_rasterize(tree, &raster);
+
+    // the rightmost node is the last node of the rightmost path
+    struct tree_t* rightmost = tree;
+    while (rightmost->right_child) {
+        rightmost = rightmost->right_child;
+    }
+    int x = image_x(rightmost, &bounds) - raster.x0, y = image_y(rightmost, &bounds);
+    assert_int_equal(raster.pixels[y * raster.pitch + x], EXPORT_NODE_COLOR);
+    assert_true(raster_has_nodes(tree, &raster));
+
+    free(raster.pixels);
+    free(raster.extents);
+    tree_free(tree);
+}
+
+static void test_rasterize_fit_to_width(void **state) {
+    struct tree_t* tree = tree_random(12, 12, 0.0f);
+    tree_compute_layout(tree);
+    const int width = 1000;
+    float x_scale = tree_fit_x_scale(tree, width);
+    assert_true(x_scale < HORIZONTAL_SCALE);
+    struct tree_bounds_t bounds = tree_bounds(tree, x_scale, VERTICAL_SPACING);
+    assert_true(bounds.width <= width);
+    assert_true(bounds.node_radius < (int)NODE_RADIUS);
+    int rows, columns;
+    tree_tile_grid(&bounds, &rows, &columns);
+    assert_int_equal(rows * columns, 1);
+
+    struct tree_raster_t raster = {
+        .bounds = bounds,
+        .extents = tree_subtree_extents(tree),
+    };
+    raster.width = raster.pitch = bounds.width;
+    raster.height = bounds.height;
+    raster.pixels = malloc(sizeof(uint32_t) * (size_t)(raster.width * raster.height));
+    tree_rasterize(tree, &raster);
+    assert_true(raster_has_nodes(tree, &raster));
+
+    free(raster.pixels);
+    free(raster.extents);
+    tree_free(tree);
+}
+
+static bool tree_layout_equal(struct tree_t *tree, struct tree_t *other) {
+    if (!tree || !other) {
+        return (tree == NULL) && (other == NULL);
+    }
+    return tree->x_pos == other->x_pos && tree->y_pos == other->y_pos &&
+        tree_layout_equal(tree->left_child, other->left_child)
+        && tree_layout_equal(tree->right_child, other->right_child);
+}
+
+static bool tree_inside_block(struct tree_t *tree, struct tree_block_t *block) {
+    if (!tree) {
+        return true;
+    }
+    return tree >= block->nodes && tree < block->nodes + block->num_nodes &&
+        tree_inside_block(tree->left_child, block) && tree_inside_block(tree->right_child, block);
+}
+
+static void test_relayout_memory_keeps_tree_and_layout(void **state) {
+    const enum tree_order_t orders[] = {
+        TREE_ORDER_PREORDER, TREE_ORDER_POSTORDER, TREE_ORDER_BFS, TREE_ORDER_VAN_EMDE_BOAS
+    };
+    const int random_tree_tests = 200;
+    for (int i = 0; i < random_tree_tests; i++) {
+        struct tree_t* tree = tree_random(1, 10, 0.4f);
+        tree_compute_layout(tree);
+        for (int order = 0; order < 4; order++) {
+            struct tree_block_t block = tree_relayout_memory(tree, orders[order]);
+            assert_non_null(block.nodes);
+            assert_int_equal(block.num_nodes, tree_count_nodes(tree));
+            assert_true(tree_inside_block(block.root, &block));
+            assert_true(tree_value_equal(tree, block.root));
+
+            tree_compute_layout(block.root);
+            assert_true(tree_layout_equal(tree, block.root));
+            tree_block_free(&block);
+        }
+        tree_free(tree);
+    }
+
+    struct tree_block_t empty = tree_relayout_memory(NULL, TREE_ORDER_BFS);
+    assert_null(empty.root);
+    tree_block_free(&empty);
+}
+
+static void test_relayout_memory_orders(void **state) {
+    const int height = 4;
+    struct tree_t* tree = tree_random(height, height, 0.0f);
+
+    struct tree_block_t preorder = tree_relayout_memory(tree, TREE_ORDER_PREORDER);
+    assert_ptr_equal(preorder.root, &preorder.nodes[0]);
+    assert_ptr_equal(preorder.root->left_child, &preorder.nodes[1]);
+    assert_ptr_equal(preorder.root->right_child, &preorder.nodes[8]);
+    tree_block_free(&preorder);
+
+    struct tree_block_t postorder = tree_relayout_memory(tree, TREE_ORDER_POSTORDER);
+    assert_ptr_equal(postorder.root, &postorder.nodes[14]);
+    assert_ptr_equal(postorder.root->left_child, &postorder.nodes[6]);
+    assert_ptr_equal(postorder.root->right_child, &postorder.nodes[13]);
+    tree_block_free(&postorder);
+
+    struct tree_block_t bfs = tree_relayout_memory(tree, TREE_ORDER_BFS);
+    for (int i = 0; 2 * i + 2 < bfs.num_nodes; i++) {
+        assert_ptr_equal(bfs.nodes[i].left_child, &bfs.nodes[2 * i + 1]);
+        assert_ptr_equal(bfs.nodes[i].right_child, &bfs.nodes[2 * i + 2]);
+    }
+    tree_block_free(&bfs);
+
+    // the top two levels come first, then each bottom subtree of height two
+    struct tree_block_t van_emde_boas = tree_relayout_memory(tree, TREE_ORDER_VAN_EMDE_BOAS);
+    struct tree_t* nodes = van_emde_boas.nodes;
+    assert_ptr_equal(van_emde_boas.root, &nodes[0]);
+    assert_ptr_equal(nodes[0].left_child, &nodes[1]);
+    assert_ptr_equal(nodes[0].right_child, &nodes[2]);
+    for (int bottom = 0; bottom < 4; bottom++) {
+        struct tree_t* bottom_root = &nodes[3 + 3 * bottom];
+        struct tree_t* parent = &nodes[1 + bottom / 2];
+        assert_ptr_equal(bottom % 2 ? parent->right_child : parent->left_child, bottom_root);
+        assert_ptr_equal(bottom_root->left_child, bottom_root + 1);
+        assert_ptr_equal(bottom_root->right_child, bottom_root + 2);
+    }
+    tree_block_free(&van_emde_boas);
+
+    tree_free(tree);
+}
+
+static int count_nodes_in_rect(struct tree_t *tree, int min_x_pos, int min_y_pos, int max_x_pos, int max_y_pos) {
+    if (!tree) {
+        return 0;
+    }
+    bool inside = tree->x_pos >= min_x_pos && tree->x_pos <= max_x_pos &&
+        tree->y_pos >= min_y_pos && tree->y_pos <= max_y_pos;
+    return inside + count_nodes_in_rect(tree->left_child, min_x_pos, min_y_pos, max_x_pos, max_y_pos)
+        + count_nodes_in_rect(tree->right_child, min_x_pos, min_y_pos, max_x_pos, max_y_pos);
+}
+
+static bool index_finds_every_node(struct tree_index_t *index, struct tree_t *tree) {
+    if (!tree) {
+        return true;
+    }
+    struct tree_index_entry_t* entry = tree_index_find(index, (float)tree->x_pos + 0.1f, (float)tree->y_pos - 0.1f, 0.5f, 0.4f);
+    return entry && entry->node == tree &&
+        index_finds_every_node(index, tree->left_child) && index_finds_every_node(index, tree->right_child);
+}
+
+static void select_entry(struct tree_index_entry_t *entry, void *data) {
+    entry->selected = true;
+}
+
+static void test_tree_index_point_and_rect_queries(void **state) {
+    const int random_tree_tests = 200;
+    for (int i = 0; i < random_tree_tests; i++) {
+        struct tree_t* tree = tree_random(1, 10, 0.4f);
+        tree_compute_layout(tree);
+        struct tree_index_t* index = tree_index_build(tree);
+        assert_non_null(index);
+        assert_int_equal(index->num_entries, tree_count_nodes(tree));
+        assert_int_equal(index->num_levels, tree_height(tree));
+
+        assert_true(index_finds_every_node(index, tree));
+        // nodes are at least MINIMUM_NODE_OFFSET apart, so the gap between them is empty
+        assert_null(tree_index_find(index, (float)tree->x_pos + 1.0f, 0.0f, 0.5f, 0.4f));
+        assert_null(tree_index_find(index, 0.0f, (float)index->num_levels + 1.0f, 0.5f, 0.4f));
+
+        const int min_x_pos = -(rand() % 20), max_x_pos = rand() % 20, min_y_pos = rand() % 5, max_y_pos = min_y_pos + rand() % 5;
+        assert_int_equal(tree_index_query_rect(index, (float)min_x_pos - 0.5f, (float)min_y_pos - 0.5f,
+                                               (float)max_x_pos + 0.5f, (float)max_y_pos + 0.5f, select_entry, NULL),
+                         count_nodes_in_rect(tree, min_x_pos, min_y_pos, max_x_pos, max_y_pos));
+        tree_index_free(index);
+        tree_free(tree);
+    }
+}
+
+static void test_tree_index_selection_survives_relayout(void **state) {
+    struct tree_t* tree = tree_random(3, 8, 0.4f);
+    tree_compute_layout(tree);
+    struct tree_index_t* index = tree_index_build(tree);
+    int num_selected = tree_index_query_rect(index, -1000.0f, 0.0f, 0.0f, 1000.0f, select_entry, NULL);
+
+    struct tree_block_t block = tree_relayout_memory(tree, TREE_ORDER_VAN_EMDE_BOAS);
+    tree_compute_layout(block.root);
+    struct tree_index_t* relaid_index = tree_index_build(block.root);
+    tree_index_copy_selection(relaid_index, index);
+    for (int i = 0; i < relaid_index->num_entries; i++) {
+        assert_true(relaid_index->entries[i].node >= block.nodes);
+        assert_true(relaid_index->entries[i].node < block.nodes + block.num_nodes);
+        assert_int_equal(relaid_index->entries[i].selected, relaid_index->entries[i].x_pos <= 0);
+        num_selected -= relaid_index->entries[i].selected;
+    }
+    assert_int_equal(num_selected, 0);
+
+    tree_index_clear_selection(relaid_index);
+    for (int i = 0; i < relaid_index->num_entries; i++) {
+        assert_false(relaid_index->entries[i].selected);
+    }
+
+    tree_index_free(relaid_index);
+    tree_index_free(index);
+    tree_block_free(&block);
+    tree_free(tree);
+}
+
+static int compare_ints(const void* a, const void* b) {
+    int left = *(const int*)a, right = *(const int*)b;
+    return (left > right) - (left < right);
+}
+
+static void collect_ids(struct tree_t *tree, int *ids, int *num_ids) {
+    if (!tree) {
+        return;
+    }
+    ids[(*num_ids)++] = tree->id;
+    collect_ids(tree->left_child, ids, num_ids);
+    collect_ids(tree->right_child, ids, num_ids);
+}
+
+static bool ids_unique(int *ids, int num_ids) {
+    qsort(ids, (size_t)num_ids, sizeof(int), compare_ints);
+    for (int i = 1; i < num_ids; i++) {
+        if (ids[i - 1] == ids[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#define NUM_BUILDER_THREADS 4
+#define NODES_PER_THREAD 10000
+
+static void* allocate_nodes(void *data) {
+    int *ids = data;
+    for (int i = 0; i < NODES_PER_THREAD; i++) {
+        struct tree_t* tree = new_tree_node();
+        ids[i] = tree->id;
+        tree_free(tree);
+    }
+    return NULL;
+}
+
+static void test_new_tree_node_ids_are_unique_across_threads(void **state) {
+    int *ids = malloc(sizeof(int) * NUM_BUILDER_THREADS * NODES_PER_THREAD);
+    pthread_t threads[NUM_BUILDER_THREADS];
+    for (int i = 0; i < NUM_BUILDER_THREADS; i++) {
+        assert_int_equal(pthread_create(&threads[i], NULL, allocate_nodes, ids + i * NODES_PER_THREAD), 0);
+    }
+    for (int i = 0; i < NUM_BUILDER_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    assert_true(ids_unique(ids, NUM_BUILDER_THREADS * NODES_PER_THREAD));
+    free(ids);
+}
+
+struct pool_builder_t {
+    struct tree_pool_t pool;
+    struct tree_t* tree;
+    int height;
+};
+
+static struct tree_t* pool_full_tree(struct tree_pool_t *pool, int height) {
+    if (height == 0) {
+        return NULL;
+    }
+    struct tree_t* tree = tree_pool_new_node(pool);
+    assert_non_null(tree);
+    tree->left_child = pool_full_tree(pool, height - 1);
+    tree->right_child = pool_full_tree(pool, height - 1);
+    return tree;
+}
+
+static void* build_pool_tree(void *data) {
+    struct pool_builder_t *builder = data;
+    tree_pool_init(&builder->pool);
+    builder->tree = pool_full_tree(&builder->pool, builder->height);
+    return NULL;
+}
+
+static void test_short_lived_pools_reserve_few_ids(void **state) {
+    const int num_pools = 1000;
+    struct tree_t* before = new_tree_node();
+    for (int i = 0; i < num_pools; i++) {
+        struct tree_pool_t pool;
+        tree_pool_init(&pool);
+        assert_non_null(tree_pool_new_node(&pool));
+        tree_pool_free(&pool);
+    }
+    struct tree_t* after = new_tree_node();
+    assert_true(after->id - before->id <= num_pools * TREE_POOL_MIN_ID_RANGE + 1);
+
+    // a busy pool grows its range without handing out an id twice
+    struct tree_pool_t pool;
+    tree_pool_init(&pool);
+    int previous = tree_pool_new_node(&pool)->id;
+    for (int i = 1; i < 3 * TREE_POOL_ID_RANGE; i++) {
+        int id = tree_pool_new_node(&pool)->id;
+        assert_true(id > previous);
+        previous = id;
+    }
+    assert_int_equal(pool.id_range, TREE_POOL_ID_RANGE);
+    tree_pool_free(&pool);
+    free(before);
+    free(after);
+}
+
+static void test_pool_trees_built_on_threads_merge_into_one_tree(void **state) {
+    const int height = 13;
+    struct pool_builder_t builders[NUM_BUILDER_THREADS];
+    pthread_t threads[NUM_BUILDER_THREADS];
+    for (int i = 0; i < NUM_BUILDER_THREADS; i++) {
+        builders[i].height = height;
+        assert_int_equal(pthread_create(&threads[i], NULL, build_pool_tree, &builders[i]), 0);
+    }
+
+    struct tree_pool_t pool;
+    tree_pool_init(&pool);
+    struct tree_t* root = tree_pool_new_node(&pool);
+    root->left_child = tree_pool_new_node(&pool);
+    root->right_child = tree_pool_new_node(&pool);
+    for (int i = 0; i < NUM_BUILDER_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+        struct tree_t* parent = i < 2 ? root->left_child : root->right_child;
+        if (i % 2 == 0) {
+            parent->left_child = builders[i].tree;
+        } else {
+            parent->right_child = builders[i].tree;
+        }
+        tree_pool_merge(&pool, &builders[i].pool);
+        assert_null(builders[i].pool.chunks);
+    }
+
+    const int num_nodes = tree_count_nodes(root);
+    assert_int_equal(num_nodes, 3 + NUM_BUILDER_THREADS * ((1 << height) - 1));
+    assert_int_equal(tree_height(root), height + 2);
+    int *ids = malloc(sizeof(int) * (size_t)num_nodes), num_ids = 0;
+    collect_ids(root, ids, &num_ids);
+    assert_true(ids_unique(ids, num_ids));
+    free(ids);
+
+    // the merged pool still hands out nodes and owns every node of the tree
+    struct tree_t* extra = tree_pool_new_node(&pool);
+    assert_non_null(extra);
+    tree_compute_layout(root);
+    tree_pool_free(&pool);
+    assert_null(pool.chunks);
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_tree_value_equal),
@@ -163,7 +642,19 @@ int main(void) {
         cmocka_unit_test(test_tree_height_measures_max_depth),
         cmocka_unit_test(test_tree_random_respects_max_and_min_heights),
         cmocka_unit_test(test_contour_has_length_equal_to_height_of_full_tree),
-        cmocka_unit_test(test_compute_layout_of_random_tree_has_same_length_contour)
+        cmocka_unit_test(test_compute_layout_of_random_tree_has_same_length_contour),
+        cmocka_unit_test(test_export_svg_writes_every_node_and_edge),
+        cmocka_unit_test(test_tree_bounds_contain_every_node),
+        cmocka_unit_test(test_rasterize_draws_nodes_and_edges),
+        cmocka_unit_test(test_rasterize_tiles_of_a_wide_tree),
+        cmocka_unit_test(test_rasterize_fit_to_width),
+        cmocka_unit_test(test_relayout_memory_keeps_tree_and_layout),
+        cmocka_unit_test(test_relayout_memory_orders),
+        cmocka_unit_test(test_tree_index_point_and_rect_queries),
+        cmocka_unit_test(test_tree_index_selection_survives_relayout),
+        cmocka_unit_test(test_new_tree_node_ids_are_unique_across_threads),
+        cmocka_unit_test(test_short_lived_pools_reserve_few_ids),
+        cmocka_unit_test(test_pool_trees_built_on_threads_merge_into_one_tree)
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
\ No newline at end of file